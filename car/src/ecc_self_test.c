@@ -0,0 +1,109 @@
+/**
+ * @file ecc_self_test.c
+ * @author Electro707 (Jamal Bouajjaj)
+ * @brief Known-answer test and cycle counts for the ECDH library
+ * @date 2023
+ *
+ * This checks that micro-ecc (with the UMAAL kernels in ecc_umaal.c) still gives the right
+ * secp192r1 results, and counts the cycles of a handshake's ECC work with the DWT cycle counter.
+ *
+ * The known values are generated with Python `cryptography` by debug/gen_ecc_vectors.py
+ */
+
+#ifdef RUN_ECC_SELF_TEST
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "inc/hw_types.h"
+#include "inc/hw_nvic.h"
+
+#include "uECC.h"
+#include "uart.h"
+#include "ecc_self_test.h"
+
+// The DWT cycle counter is not defined by TivaWare
+#define DWT_CTRL                0xE0001000
+#define DWT_CYCCNT              0xE0001004
+#define DWT_CTRL_CYCCNTENA      0x00000001  // Enable the cycle counter
+#define NVIC_DBG_INT_TRCENA     0x01000000  // Enable the DWT
+
+static const uint8_t private_a[24] = {
+  0x43, 0x99, 0x5B, 0x99, 0x73, 0x82, 0x1D, 0xA9, 0x54, 0x0E, 0x43, 0x78,
+  0xE1, 0x47, 0x03, 0x4C, 0x5D, 0x9B, 0x51, 0xE6, 0x92, 0xC3, 0x21, 0x87
+};
+static const uint8_t public_a[48] = {
+  0x2C, 0x7A, 0xD2, 0x00, 0x59, 0xF1, 0x56, 0xD9, 0xAB, 0xDA, 0x25, 0x0F,
+  0xC1, 0x51, 0xE8, 0x24, 0x30, 0x48, 0xF3, 0xC5, 0x0C, 0xBF, 0x90, 0xF6,
+  0x7B, 0x59, 0x1A, 0x32, 0x7A, 0x80, 0xDA, 0x56, 0xF7, 0xFE, 0xF0, 0x5A,
+  0x6F, 0x3D, 0xCE, 0x16, 0xB7, 0x95, 0xFB, 0xC3, 0x7B, 0x42, 0x79, 0x53
+};
+static const uint8_t public_b[48] = {
+  0x9C, 0x0D, 0xF9, 0x19, 0x7D, 0x84, 0x9F, 0x92, 0xCA, 0x86, 0xCB, 0x21,
+  0x3C, 0x35, 0x5B, 0xC6, 0xD5, 0x36, 0x4D, 0xB5, 0x3D, 0x57, 0x8A, 0x16,
+  0x88, 0xF4, 0x73, 0x5C, 0x05, 0xF4, 0x8B, 0xDD, 0x31, 0x3F, 0x57, 0x72,
+  0xDF, 0xF0, 0x32, 0x70, 0xC8, 0xDE, 0x0E, 0xB7, 0x07, 0x5B, 0x0A, 0xEB
+};
+static const uint8_t shared_secret_ab[24] = {
+  0x66, 0x8B, 0x05, 0x0C, 0xFA, 0x7C, 0xD1, 0xAD, 0x90, 0xD4, 0x47, 0xEE,
+  0x3E, 0x6C, 0x05, 0xC6, 0xFA, 0x1B, 0x78, 0xDE, 0x32, 0xE3, 0x9E, 0x6D
+};
+
+static void write_string(const char *str){
+  uart_write(HOST_UART, (uint8_t *)str, strlen(str));
+}
+
+static void write_number_line(const char *name, uint32_t value){
+  char digits[10];
+  uint8_t n = 0;
+
+  do{
+    digits[n++] = '0' + (value % 10);
+    value /= 10;
+  } while(value != 0);
+
+  write_string(name);
+  while(n != 0){
+    uart_writeb(HOST_UART, digits[--n]);
+  }
+  uart_writeb(HOST_UART, '\n');
+}
+
+void run_ecc_self_test(uECC_Curve curve){
+  uint8_t public_key[sizeof(public_a)];
+  uint8_t secret[sizeof(shared_secret_ab)];
+  uint32_t start, public_key_cycles, shared_secret_cycles;
+  bool passed = true;
+
+  // Known-answer checks: the public key of A, and the secret shared between A and B
+  if(!uECC_compute_public_key(private_a, public_key, curve) ||
+     memcmp(public_key, public_a, sizeof(public_a)) != 0){
+    passed = false;
+  }
+  if(!uECC_shared_secret(public_b, private_a, secret, curve) ||
+     memcmp(secret, shared_secret_ab, sizeof(shared_secret_ab)) != 0){
+    passed = false;
+  }
+
+  // Count the cycles of a handshake's ECC work. uECC_make_key is timed as
+  // uECC_compute_public_key on a fixed key, which is the same work without get_random_bytes
+  HWREG(NVIC_DBG_INT) |= NVIC_DBG_INT_TRCENA;
+  HWREG(DWT_CYCCNT) = 0;
+  HWREG(DWT_CTRL) |= DWT_CTRL_CYCCNTENA;
+
+  start = HWREG(DWT_CYCCNT);
+  uECC_compute_public_key(private_a, public_key, curve);
+  public_key_cycles = HWREG(DWT_CYCCNT) - start;
+
+  start = HWREG(DWT_CYCCNT);
+  uECC_shared_secret(public_b, private_a, secret, curve);
+  shared_secret_cycles = HWREG(DWT_CYCCNT) - start;
+
+  write_string(passed ? "ECC self test: PASS\n" : "ECC self test: FAIL\n");
+  write_number_line("uECC_compute_public_key cycles: ", public_key_cycles);
+  write_number_line("uECC_shared_secret cycles: ", shared_secret_cycles);
+  write_number_line("Handshake cycles: ", public_key_cycles + shared_secret_cycles);
+}
+
+#endif
@@ -0,0 +1,87 @@
+#!/usr/bin/python3 -u
+"""
+Checks the firmware's unrolled secp192r1 multiply and square (`src/ecc_umaal.c` in both
+the car and fob) on this PC against Python's integers.
+
+The file is built with the host C compiler, where each UMAAL is done in C instead, so this
+checks everything but the instruction itself; the firmware's ECC self test
+(`make ECC_SELF_TEST=1`) covers that on the board.
+"""
+
+import ctypes
+import os
+import random
+import subprocess
+import sys
+import tempfile
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parent.parent
+SOURCES = [ROOT / "car" / "src" / "ecc_umaal.c", ROOT / "fob" / "src" / "ecc_umaal.c"]
+
+WORDS = 6
+RANDOM_CASES = 20000
+
+
+def to_words(value: int, n: int):
+    return (ctypes.c_uint32 * n)(*[(value >> (32 * i)) & 0xFFFFFFFF for i in range(n)])
+
+
+def from_words(words) -> int:
+    return sum(w << (32 * i) for i, w in enumerate(words))
+
+
+def build(source: Path, out_dir: str) -> ctypes.CDLL:
+    lib_path = os.path.join(out_dir, source.parent.parent.name + "_ecc_umaal.so")
+    cc = os.environ.get("CC", "cc")
+    subprocess.run([cc, "-O2", "-shared", "-fPIC", "-o", lib_path, str(source)], check=True)
+    lib = ctypes.CDLL(lib_path)
+    lib.uECC_vli_mult.argtypes = [ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_int8]
+    lib.uECC_vli_square.argtypes = [ctypes.c_void_p, ctypes.c_void_p, ctypes.c_int8]
+    return lib
+
+
+def test_values():
+    top = (1 << (32 * WORDS)) - 1
+    p192 = 2**192 - 2**64 - 1
+    edges = [0, 1, 2, top, top - 1, p192, p192 - 1, 1 << 191, (1 << 32) - 1, 0xFFFFFFFF << 160]
+    for a in edges:
+        for b in edges:
+            yield a, b
+    rng = random.Random(192)
+    for _ in range(RANDOM_CASES):
+        yield rng.getrandbits(192), rng.getrandbits(192)
+
+
+def check(lib: ctypes.CDLL) -> int:
+    failures = 0
+    result = (ctypes.c_uint32 * (2 * WORDS))()
+    for a, b in test_values():
+        lib.uECC_vli_mult(result, to_words(a, WORDS), to_words(b, WORDS), WORDS)
+        if from_words(result) != a * b:
+            print(f"mult mismatch: {a:#x} * {b:#x}")
+            failures += 1
+        lib.uECC_vli_square(result, to_words(a, WORDS), WORDS)
+        if from_words(result) != a * a:
+            print(f"square mismatch: {a:#x}^2")
+            failures += 1
+    return failures
+
+
+def main():
+    if SOURCES[0].read_bytes() != SOURCES[1].read_bytes():
+        print("The car and fob copies of ecc_umaal.c differ")
+        return 1
+
+    with tempfile.TemporaryDirectory() as out_dir:
+        failures = check(build(SOURCES[1], out_dir))
+
+    if failures:
+        print(f"ECC kernel check failed: {failures} mismatch(es)")
+        return 1
+    print("ECC kernel check passed")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,49 @@
+#!/usr/bin/python3 -u
+"""
+Generates the secp192r1 known-answer values used by the firmware's ECC self test
+(`src/ecc_self_test.c` in both the car and fob), using Python `cryptography`.
+
+Both private keys are derived from fixed strings, so running this again must print the
+same arrays that are in the firmware.
+"""
+
+import hashlib
+
+from cryptography.hazmat.primitives.asymmetric import ec
+from cryptography.hazmat.primitives.serialization import PublicFormat
+from cryptography.hazmat.primitives.serialization import Encoding
+
+SECP192R1_ORDER = 0xFFFFFFFFFFFFFFFFFFFFFFFF99DEF836146BC9B1B4D22831
+
+
+def fixed_private_key(seed: bytes) -> ec.EllipticCurvePrivateKey:
+    value = int.from_bytes(hashlib.sha256(seed).digest()[:24], 'big') % SECP192R1_ORDER
+    return ec.derive_private_key(value, ec.SECP192R1())
+
+
+def public_bytes(key: ec.EllipticCurvePrivateKey) -> bytes:
+    # micro-ecc's public keys are X then Y, without the 0x04 prefix
+    return key.public_key().public_bytes(Encoding.X962, PublicFormat.UncompressedPoint)[1:]
+
+
+def print_c_array(name: str, data: bytes):
+    print(f"static const uint8_t {name}[{len(data)}] = {{")
+    rows = [data[i:i+12] for i in range(0, len(data), 12)]
+    for n, row in enumerate(rows):
+        line = ", ".join(f"0x{b:02X}" for b in row)
+        print(f"  {line}{',' if n != len(rows) - 1 else ''}")
+    print("};")
+
+
+def main():
+    key_a = fixed_private_key(b"unewhaven ecc self test a")
+    key_b = fixed_private_key(b"unewhaven ecc self test b")
+
+    print_c_array("private_a", key_a.private_numbers().private_value.to_bytes(24, 'big'))
+    print_c_array("public_a", public_bytes(key_a))
+    print_c_array("public_b", public_bytes(key_b))
+    print_c_array("shared_secret_ab", key_a.exchange(ec.ECDH(), key_b.public_key()))
+
+
+if __name__ == "__main__":
+    main()
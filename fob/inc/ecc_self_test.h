@@ -0,0 +1,25 @@
+/**
+ * @file ecc_self_test.h
+ * @author Electro707 (Jamal Bouajjaj)
+ * @brief Known-answer test and cycle counts for the ECDH library
+ * @date 2023
+ *
+ * Only built with RUN_ECC_SELF_TEST (`make ECC_SELF_TEST=1`), which is for debugging only.
+ */
+
+#ifndef ECC_SELF_TEST_H
+#define ECC_SELF_TEST_H
+
+#ifdef RUN_ECC_SELF_TEST
+#include "uECC.h"
+
+/**
+ * @brief Checks micro-ecc against known secp192r1 values and measures a handshake
+ *
+ * The result and the cycle counts of uECC_make_key and uECC_shared_secret are
+ * printed over the host UART.
+ */
+void run_ecc_self_test(uECC_Curve curve);
+#endif
+
+#endif
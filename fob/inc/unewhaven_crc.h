@@ -1,6 +1,16 @@
 #ifndef UNEWHAVEN_FUCK_ABE_CRC
 #define UNEWHAVEN_FUCK_ABE_CRC
 
+#include <stdbool.h>
+#include <stdint.h>
+
+// Bounds on a received frame's message data (without the CRC). Per the protocol, a whole
+// frame (data + CRC) is at most 80 bytes
+#define FRAME_MINIMUM_DATA 3
+#define FRAME_MAXIMUM_DATA 78
+
 uint16_t calculate_crc(uint8_t *data, uint8_t len);
+uint8_t pack_frame(uint8_t *frame, uint8_t len);
+bool check_frame(uint8_t *data, uint8_t len, uint16_t crc);
 
 #endif
\ No newline at end of file
@@ -32,6 +32,7 @@
 #include "uECC.h"
 #include "unewhaven_crc.h"
 #include "firmware.h"
+#include "ecc_self_test.h"
 
 #include "blake2.h"
 
@@ -43,6 +44,10 @@
 #warning("Running UART unencrypted!!!")
 #endif
 
+#ifdef RUN_ECC_SELF_TEST
+#warning("Running with the ECC self test!!!")
+#endif
+
 #ifdef RUN_WITH_DEBUG_UART
 #warning("RUNNING WITH DEBUG UART!!!!")
 #endif
@@ -85,6 +90,10 @@ void setup_uart_links(void) {
 
   uECC_set_rng(get_random_bytes);
 
+#ifdef RUN_ECC_SELF_TEST
+  run_ecc_self_test(curve);
+#endif
+
 }
 
 void receive_host_uart(void){
@@ -143,13 +152,8 @@ void receive_anything_uart(uint32_t uart_base, DATA_TRANSFER_T *host){
  * underlaying communication protocol is the same.
 */
 void process_received_packet(DATA_TRANSFER_T *host){
-  if(host->buffer_index < 3 || host->buffer_index > MAXIMUM_DATA_BUFFER){  // Smallest message must include at least ony byte and CRC
-    // TODO: Raise error: too short
-    return;
-  }
-  // Check CRC with the rest of the message
-  uint16_t calc_crc = calculate_crc(host->buffer, host->buffer_index);
-  if(calc_crc != host->crc){
+  // Check the message length, and the CRC with the rest of the message
+  if(!check_frame(host->buffer, host->buffer_index, host->crc)){
     // TODO: Raise error
     return;
   }
@@ -271,13 +275,8 @@ void generate_send_message(DATA_TRANSFER_T *host, COMMAND_BYTE_e command, uint8_
   }
   #endif
 
-  // CRC for overall message
-  uint16_t crc = calculate_crc(&to_send_msg[1], msg_len);
-  to_send_msg[1+msg_len++] = (crc >> 8) & 0xFF;
-  to_send_msg[1+msg_len++] = crc & 0xFF;
-  // Length of overall message
-  to_send_msg[0] = msg_len;
-  msg_len += 1;   // This is only for the next function
+  // CRC and length for overall message
+  msg_len = pack_frame(to_send_msg, msg_len);
   
   uart_write(host->uart_base, to_send_msg, msg_len);
 }
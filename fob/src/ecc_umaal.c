@@ -0,0 +1,131 @@
+/**
+ * @file ecc_umaal.c
+ * @author Electro707 (Jamal Bouajjaj)
+ * @brief Unrolled 6-word (secp192r1) multiply and square for micro-ecc, using UMAAL
+ * @date 2023
+ *
+ * These replace micro-ecc's own uECC_vli_mult and uECC_vli_square. The Makefile builds
+ * micro-ecc with asm_mult and asm_square set, so it leaves both out, and with
+ * uECC_ENABLE_VLI_API so it calls these external ones instead.
+ *
+ * Only secp192r1 is built in, so every call is for 6 words and num_words is not used.
+ * The full 12-word product is returned; micro-ecc's secp192r1 fast reduction is still
+ * what reduces it, as uECC_vli_modMult_fast always calls it after uECC_vli_mult.
+ *
+ * On the Cortex-M4, each umaal() below is a single UMAAL instruction:
+ *    hi:lo = a * b + lo + hi, which can never overflow 64 bits.
+ * Elsewhere it is done in C, so debug/check_ecc_kernels.py can check these on a PC.
+ */
+
+#include <stdint.h>
+
+#define ECC_WORDS 6
+
+static inline __attribute__((always_inline)) void umaal(uint32_t *lo, uint32_t *hi, uint32_t a, uint32_t b){
+#if defined(__ARM_ARCH_7EM__)
+  __asm__ ("umaal %0, %1, %2, %3" : "+r" (*lo), "+r" (*hi) : "r" (a), "r" (b));
+#else
+  uint64_t r = (uint64_t)a * b + *lo + *hi;
+  *lo = (uint32_t)r;
+  *hi = (uint32_t)(r >> 32);
+#endif
+}
+
+// One row of the multiply: r[i..i+5] += a[0..5] * b[i], with the carry going into r[i+6]
+#define MULT_ROW(i) \
+  carry = 0; \
+  umaal(&r[(i)+0], &carry, a[0], b[i]); \
+  umaal(&r[(i)+1], &carry, a[1], b[i]); \
+  umaal(&r[(i)+2], &carry, a[2], b[i]); \
+  umaal(&r[(i)+3], &carry, a[3], b[i]); \
+  umaal(&r[(i)+4], &carry, a[4], b[i]); \
+  umaal(&r[(i)+5], &carry, a[5], b[i]); \
+  r[(i)+6] = carry;
+
+void uECC_vli_mult(uint32_t *result, const uint32_t *left, const uint32_t *right, int8_t num_words){
+  const uint32_t a[ECC_WORDS] = {left[0], left[1], left[2], left[3], left[4], left[5]};
+  const uint32_t b[ECC_WORDS] = {right[0], right[1], right[2], right[3], right[4], right[5]};
+  uint32_t r[2*ECC_WORDS] = {0};
+  uint32_t carry;
+  uint8_t i;
+
+  (void)num_words;
+
+  MULT_ROW(0)
+  MULT_ROW(1)
+  MULT_ROW(2)
+  MULT_ROW(3)
+  MULT_ROW(4)
+  MULT_ROW(5)
+
+  for(i = 0; i < 2*ECC_WORDS; i++){
+    result[i] = r[i];
+  }
+}
+
+// Adds a[i]^2 into r[2i], r[2i+1] along with the carry from the previous word
+#define SQUARE_DIAGONAL(i) \
+  umaal(&r[2*(i)], &carry, a[i], a[i]); \
+  sum = (uint64_t)r[2*(i)+1] + carry; \
+  r[2*(i)+1] = (uint32_t)sum; \
+  carry = (uint32_t)(sum >> 32);
+
+void uECC_vli_square(uint32_t *result, const uint32_t *left, int8_t num_words){
+  const uint32_t a[ECC_WORDS] = {left[0], left[1], left[2], left[3], left[4], left[5]};
+  uint32_t r[2*ECC_WORDS] = {0};
+  uint32_t carry;
+  uint64_t sum;
+  int8_t i;
+
+  (void)num_words;
+
+  // The products a[i] * a[j] with i < j, which are each counted twice in the square
+  carry = 0;
+  umaal(&r[1], &carry, a[1], a[0]);
+  umaal(&r[2], &carry, a[2], a[0]);
+  umaal(&r[3], &carry, a[3], a[0]);
+  umaal(&r[4], &carry, a[4], a[0]);
+  umaal(&r[5], &carry, a[5], a[0]);
+  r[6] = carry;
+
+  carry = 0;
+  umaal(&r[3], &carry, a[2], a[1]);
+  umaal(&r[4], &carry, a[3], a[1]);
+  umaal(&r[5], &carry, a[4], a[1]);
+  umaal(&r[6], &carry, a[5], a[1]);
+  r[7] = carry;
+
+  carry = 0;
+  umaal(&r[5], &carry, a[3], a[2]);
+  umaal(&r[6], &carry, a[4], a[2]);
+  umaal(&r[7], &carry, a[5], a[2]);
+  r[8] = carry;
+
+  carry = 0;
+  umaal(&r[7], &carry, a[4], a[3]);
+  umaal(&r[8], &carry, a[5], a[3]);
+  r[9] = carry;
+
+  carry = 0;
+  umaal(&r[9], &carry, a[5], a[4]);
+  r[10] = carry;
+
+  // Double them
+  for(i = 2*ECC_WORDS-1; i > 0; i--){
+    r[i] = (r[i] << 1) | (r[i-1] >> 31);
+  }
+  r[0] <<= 1;
+
+  // And add the squares a[i]^2
+  carry = 0;
+  SQUARE_DIAGONAL(0)
+  SQUARE_DIAGONAL(1)
+  SQUARE_DIAGONAL(2)
+  SQUARE_DIAGONAL(3)
+  SQUARE_DIAGONAL(4)
+  SQUARE_DIAGONAL(5)
+
+  for(i = 0; i < 2*ECC_WORDS; i++){
+    result[i] = r[i];
+  }
+}
@@ -5,9 +5,11 @@
  * @date 2023
  * @copyright Copyright (c) Electro707
  * 
- * This file really has one function: calculate_crc
+ * This file really has two functions: calculate_crc, and pack_frame which wraps
+ *   a message with its CRC and length
  * 
  * I felt that it would be nice to have it in it's own file, so it is.
+ * The host tools also build this file for their native framing module.
  * The CRC is also known as MODBUS-16 CRC
  */
 
@@ -60,4 +62,35 @@ uint16_t calculate_crc(uint8_t *data, uint8_t len){
     }
 
     return crc;
+}
+
+/**
+ * Packs a message into a frame in-place.
+ *
+ * The message data is expected at frame[1..len]. The big-endian CRC is appended
+ * after it and the frame length (data + CRC) is written to frame[0].
+ * Returns the total number of bytes to be sent, including the length byte.
+ */
+uint8_t pack_frame(uint8_t *frame, uint8_t len){
+    uint16_t crc = calculate_crc(&frame[1], len);
+
+    frame[1+len++] = (crc >> 8) & 0xFF;
+    frame[1+len++] = crc & 0xFF;
+    frame[0] = len;
+
+    return len + 1;
+}
+
+/**
+ * Checks a received frame's message data against the frame's CRC.
+ *
+ * Returns true if the data length is between FRAME_MINIMUM_DATA and FRAME_MAXIMUM_DATA,
+ * and the CRC matches.
+ */
+bool check_frame(uint8_t *data, uint8_t len, uint16_t crc){
+    if(len < FRAME_MINIMUM_DATA || len > FRAME_MAXIMUM_DATA){
+        return false;
+    }
+
+    return calculate_crc(data, len) == crc;
 }
\ No newline at end of file
@@ -39,6 +39,41 @@ from cryptography.hazmat.primitives.serialization import Encoding
 
 from cryptography.hazmat.primitives.ciphers import Cipher, algorithms, modes
 
+MAXIMUM_FRAME_LENGTH = 80
+MINIMUM_FRAME_DATA = 3     # Same as the firmware's FRAME_MINIMUM_DATA
+
+crc_def = crcmod.mkCrcFun(0x18005, rev=True, initCrc=0xFFFF, xorOut=0x0000)
+
+
+def py_pack_frame(data: bytes) -> bytes:
+    """
+    Pure Python version of the firmware's `pack_frame`: length, data, then CRC
+    """
+    if len(data) + 2 > MAXIMUM_FRAME_LENGTH:
+        raise ValueError("Data is too long for a frame")
+    return bytes([len(data) + 2]) + data + struct.pack(">H", crc_def(data))
+
+
+def py_unpack_frame(data_plus_crc: bytes) -> bytes:
+    """
+    Pure Python version of the firmware's `check_frame`: checks the length and CRC of a
+    received frame (without it's length byte) and returns it's data
+    """
+    if len(data_plus_crc) < MINIMUM_FRAME_DATA + 2 or len(data_plus_crc) > MAXIMUM_FRAME_LENGTH:
+        raise ValueError("Invalid frame length")
+    data = bytes(data_plus_crc[:-2])
+    if struct.unpack(">H", data_plus_crc[-2:])[0] != crc_def(data):
+        raise ValueError("Frame CRC mismatch")
+    return data
+
+
+# Use the native module (built from the firmware's own CRC source) if it's available
+try:
+    from unewhaven_native import pack_frame, unpack_frame
+except ImportError:
+    pack_frame, unpack_frame = py_pack_frame, py_unpack_frame
+
+
 class ReadException(Exception):
     pass
 
@@ -46,7 +81,6 @@ class ReadException(Exception):
 class FobConnection:
     def __init__(self, s: socket.socket):
         self.log = logging.getLogger('device')
-        self.crc_def = crcmod.mkCrcFun(0x18005, rev=True, initCrc=0xFFFF, xorOut=0x0000)
         self.s = s
 
         self.aes_key = None     # type: bytearray
@@ -61,19 +95,17 @@ class FobConnection:
         self.log.debug("Data len received: %s", data_len)
         data_len = int.from_bytes(data_len, 'big')
 
-        if data_len > 80:
-            self.log.error("Data length is more than 80")
+        if data_len > MAXIMUM_FRAME_LENGTH:
+            self.log.error("Data length is more than %d", MAXIMUM_FRAME_LENGTH)
             raise ReadException()
 
         data_plus_crc = self._receive_until(data_len)
         self.log.debug("Data + CRC: %s", data_plus_crc)
 
-        data = data_plus_crc[:-2]
-
-        device_crc = struct.unpack(">H", data_plus_crc[-2:])[0]
-        calc_crc = self.crc_def(data)
-        self.log.debug("Received for device CRC: %s, Calc: %s", device_crc, calc_crc)
-        if device_crc != calc_crc:
+        try:
+            data = unpack_frame(data_plus_crc)
+        except ValueError as e:
+            self.log.error("Invalid frame received: %s", e)
             raise ReadException()
 
         if encrypted:
@@ -100,23 +132,13 @@ class FobConnection:
         self.log.debug("Sending Data %s", data)
 
         if encrypted:
-            padding = 16 - (data_len % 16)
-            data += bytes(padding)
-            data_len = len(data)
+            # Pad to the AES block size the same way the firmware does
+            data = bytes(data) + bytes(-data_len % 16)
 
             enc = self.cipher.encryptor()
             data = enc.update(data) + enc.finalize()
 
-        to_send = bytearray(1)
-        to_send[0] = data_len + 2     # Add CRC to length
-
-        cal_crc = self.crc_def(data)
-        cal_crc = struct.pack(">H", cal_crc)
-        self.log.debug("Calc CRC: %s", cal_crc)
-
-        to_send += data
-        to_send.append(cal_crc[0])
-        to_send.append(cal_crc[1])
+        to_send = pack_frame(bytes(data))
 
         self.log.debug("Sending %s", to_send)
 
@@ -159,7 +181,10 @@ class FobConnection:
         Internal function that receives bytes until n bytes is received
         """
         d = bytearray()
-        while n > 0:
-            d += self.s.recv(1)
-            n -= 1
+        while len(d) < n:
+            r = self.s.recv(n - len(d))
+            if not r:
+                self.log.error("Connection closed while receiving")
+                raise ReadException()
+            d += r
         return d
@@ -0,0 +1,137 @@
+/**
+ * @file unewhaven_native.c
+ * @author Electro707 (Jamal Bouajjaj)
+ * @brief Native Python module for the host tools' frame packing and CRC
+ * @date 2023
+ *
+ * This module wraps the firmware's own `unewhaven_crc.c` (calculate_crc, pack_frame and
+ * check_frame) so the host tools frame and check their messages with the exact same code
+ * as the fob and car.
+ *
+ * It is optional: if it's not built, `common.py` falls back to its pure Python version.
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#include "unewhaven_crc.h"
+
+#define CRC_LENGTH 2
+#define MAXIMUM_FRAME_LENGTH (FRAME_MAXIMUM_DATA + CRC_LENGTH)
+
+/**
+ * crc(data) -> int
+ *
+ * Calculates the MODBUS-16 CRC of the given data, which must fit in a frame
+ */
+static PyObject *native_crc(PyObject *self, PyObject *args){
+  Py_buffer data;
+  uint16_t crc;
+
+  (void)self;
+  if(!PyArg_ParseTuple(args, "y*", &data)){
+    return NULL;
+  }
+  if(data.len + CRC_LENGTH > MAXIMUM_FRAME_LENGTH){
+    PyBuffer_Release(&data);
+    PyErr_SetString(PyExc_ValueError, "Data is too long for a frame");
+    return NULL;
+  }
+
+  crc = calculate_crc((uint8_t *)data.buf, (uint8_t)data.len);
+  PyBuffer_Release(&data);
+
+  return PyLong_FromUnsignedLong(crc);
+}
+
+/**
+ * pack_frame(data) -> bytes
+ *
+ * Packs the (already encrypted and padded) data into a frame: length, data, then CRC
+ */
+static PyObject *native_pack_frame(PyObject *self, PyObject *args){
+  Py_buffer data;
+  uint8_t frame[1+MAXIMUM_FRAME_LENGTH];
+  uint8_t frame_len;
+
+  (void)self;
+  if(!PyArg_ParseTuple(args, "y*", &data)){
+    return NULL;
+  }
+  if(data.len + CRC_LENGTH > MAXIMUM_FRAME_LENGTH){
+    PyBuffer_Release(&data);
+    PyErr_SetString(PyExc_ValueError, "Data is too long for a frame");
+    return NULL;
+  }
+
+  memcpy(&frame[1], data.buf, data.len);
+  frame_len = pack_frame(frame, (uint8_t)data.len);
+  PyBuffer_Release(&data);
+
+  return PyBytes_FromStringAndSize((const char *)frame, frame_len);
+}
+
+/**
+ * unpack_frame(data_plus_crc) -> bytes
+ *
+ * Checks the CRC of a received frame (without it's length byte) and returns it's data.
+ * Raises a ValueError if the data's length is out of bounds or the CRC does not match
+ */
+static PyObject *native_unpack_frame(PyObject *self, PyObject *args){
+  Py_buffer frame;
+  const uint8_t *buf;
+  uint8_t data_len;
+  uint16_t frame_crc;
+  PyObject *ret;
+
+  (void)self;
+  if(!PyArg_ParseTuple(args, "y*", &frame)){
+    return NULL;
+  }
+  // Only so the CRC can be split off and the length fits in a byte, check_frame does the rest
+  if(frame.len < CRC_LENGTH || frame.len > MAXIMUM_FRAME_LENGTH){
+    PyBuffer_Release(&frame);
+    PyErr_SetString(PyExc_ValueError, "Invalid frame length");
+    return NULL;
+  }
+
+  buf = (const uint8_t *)frame.buf;
+  data_len = (uint8_t)(frame.len - CRC_LENGTH);
+  frame_crc = ((uint16_t)buf[data_len] << 8) | buf[data_len+1];
+
+  if(!check_frame((uint8_t *)buf, data_len, frame_crc)){
+    PyBuffer_Release(&frame);
+    PyErr_SetString(PyExc_ValueError, "Invalid frame length or CRC");
+    return NULL;
+  }
+
+  ret = PyBytes_FromStringAndSize((const char *)buf, data_len);
+  PyBuffer_Release(&frame);
+  return ret;
+}
+
+static PyMethodDef native_methods[] = {
+  {"crc", native_crc, METH_VARARGS, "Calculates the MODBUS-16 CRC of the data"},
+  {"pack_frame", native_pack_frame, METH_VARARGS, "Packs data into a frame"},
+  {"unpack_frame", native_unpack_frame, METH_VARARGS, "Checks and unpacks a frame's data"},
+  {NULL, NULL, 0, NULL}
+};
+
+static struct PyModuleDef native_module = {
+  PyModuleDef_HEAD_INIT,
+  "unewhaven_native",
+  "Firmware frame packing and CRC for the host tools",
+  -1,
+  native_methods,
+  NULL,
+  NULL,
+  NULL,
+  NULL
+};
+
+PyMODINIT_FUNC PyInit_unewhaven_native(void){
+  return PyModule_Create(&native_module);
+}